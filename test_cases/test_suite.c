@@ -1,7 +1,8 @@
 /*
  * Automated Test Suite for Banking System Application
  * 
- * This file contains automated tests for the top 10 critical test cases.
+ * This file contains automated tests for the critical test cases.
+ * The application source (../main.C) is included directly so tests can call it.
  * Compile with: gcc -o test_suite test_suite.c -lm
  * Run with: ./test_suite
  */
@@ -17,11 +18,18 @@
     #include <direct.h>
     #define mkdir(dir) _mkdir(dir)
     #define rmdir(dir) _rmdir(dir)
+    #define chdir(dir) _chdir(dir)
 #else
     #include <unistd.h>
     #include <sys/types.h>
 #endif
 
+// Pull in the application so tests can call its functions directly
+// (its main() is renamed so the test runner's main() is used)
+#define main banking_main
+#include "../main.C"
+#undef main
+
 // Test result tracking
 typedef struct {
     int total_tests;
@@ -596,6 +604,165 @@ int test_complete_lifecycle() {
     return 1;
 }
 
+// Check whether a file contains a line with the given text
+int file_contains(const char *filename, const char *text) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) return 0;
+    
+    char line[512];
+    int found = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strstr(line, text) != NULL) {
+            found = 1;
+            break;
+        }
+    }
+    
+    fclose(fp);
+    return found;
+}
+
+// Count lines in a file that start with the given prefix
+int count_lines_with_prefix(const char *filename, const char *prefix) {
+    FILE *fp = fopen(filename, "r");
+    if (fp == NULL) return 0;
+    
+    char line[512];
+    int count = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        if (strncmp(line, prefix, strlen(prefix)) == 0) count++;
+    }
+    
+    fclose(fp);
+    return count;
+}
+
+// Look up a standing order's next run time. Returns -1 if the order is not in the file
+long long read_standing_order_next_run(int order_id) {
+    FILE *fp = fopen("../database/standing_orders.txt", "r");
+    if (fp == NULL) return -1;
+    
+    char line[256];
+    long long result = -1;
+    while (fgets(line, sizeof(line), fp)) {
+        int id, from, to, interval;
+        double amount;
+        long long next_run;
+        if (sscanf(line, "%d|%d|%d|%lf|%d|%lld", &id, &from, &to, &amount, 
+                   &interval, &next_run) == 6 && id == order_id) {
+            result = next_run;
+            break;
+        }
+    }
+    
+    fclose(fp);
+    return result;
+}
+
+// Forget any standing orders loaded by an earlier test
+void reset_standing_queue() {
+    free(standing_queue.orders);
+    memset(&standing_queue, 0, sizeof(standing_queue));
+    standing_queue.next_order_id = 1;
+}
+
+// TC-SO-001: Standing Order Batch Processing
+int test_standing_order_batch() {
+    TEST_START("TC-SO-001: Standing Order Batch Processing");
+    setup_test_environment();
+    reset_standing_queue();
+    
+    int sender_account = 1000009;
+    int receiver_account = 1000010;
+    int missing_account = 1000099;
+    int corrupted_account = 1000011;
+    
+    create_test_account("Standing Sender", "7777771", "Savings", "1212", 
+                       sender_account, 150.00);
+    create_test_account("Standing Receiver", "7777772", "Current", "3434", 
+                       receiver_account, 0.00);
+    
+    // Still listed in the index, but its file cannot be validated
+    create_test_account("Standing Corrupted", "7777773", "Savings", "5656", 
+                       corrupted_account, 10.00);
+    char account_file[100];
+    sprintf(account_file, "../database/%d.txt", corrupted_account);
+    FILE *fp = fopen(account_file, "w");
+    ASSERT_TRUE(fp != NULL, "Could not corrupt account file");
+    fprintf(fp, "Corrupted data\n");
+    fclose(fp);
+    
+    time_t now = time(NULL);
+    long long due_time = (long long)now - 60;
+    long long future_time = (long long)now + 10LL * 24 * 60 * 60;
+    
+    // Orders 1 and 2 are due at the same time; order 2 is listed first but
+    // order 1 must run first (ties are broken by order ID)
+    // Format: OrderID|Sender|Receiver|Amount|IntervalDays|NextRun
+    fp = fopen("../database/standing_orders.txt", "w");
+    ASSERT_TRUE(fp != NULL, "Could not create standing orders file");
+    fprintf(fp, "2|%d|%d|100.00|30|%lld\n", sender_account, receiver_account, due_time);
+    fprintf(fp, "1|%d|%d|100.00|30|%lld\n", sender_account, receiver_account, due_time);
+    fprintf(fp, "3|%d|%d|5.00|7|%lld\n", sender_account, missing_account, due_time);
+    fprintf(fp, "4|%d|%d|20.00|7|%lld\n", receiver_account, sender_account, future_time);
+    fprintf(fp, "5|%d|%d|5.00|7|%lld\n", sender_account, corrupted_account, due_time);
+    fclose(fp);
+    
+    // Run the real scheduler against ../database
+    ASSERT_TRUE(chdir("..") == 0, "Could not change to application directory");
+    int processed = process_due_standing_orders(now);
+    long long expected_next_run = (long long)advance_run_date((time_t)due_time, 30);
+    long long expected_weekly_run = (long long)advance_run_date((time_t)due_time, 7);
+    ASSERT_TRUE(chdir("test_cases") == 0, "Could not return to test_cases directory");
+    
+    ASSERT_EQUAL(4, processed, "Four orders should be due in the batch");
+    
+    // Order 1 fits the balance (100.00 + 2% fee); order 2 is then rejected
+    ASSERT_DOUBLE_EQUAL(48.00, read_account_balance(sender_account), 0.01, 
+                       "Sender balance after batch incorrect");
+    ASSERT_DOUBLE_EQUAL(100.00, read_account_balance(receiver_account), 0.01, 
+                       "Receiver balance after batch incorrect");
+    ASSERT_TRUE(file_contains("../database/transaction.log", "Standing Order #1: Transfer to Account"), 
+                "Order #1 should run first");
+    ASSERT_TRUE(file_contains("../database/transaction.log", "Standing Order #2: Transfer to Account 1000010 failed (insufficient balance)"), 
+                "Order #2 should be rejected for insufficient balance");
+    printf("  - Tie on run time executed by order ID ✓\n");
+    
+    // Both due orders move forward one interval; the future order is untouched
+    ASSERT_TRUE(read_standing_order_next_run(1) == expected_next_run, "Order #1 not rescheduled");
+    ASSERT_TRUE(read_standing_order_next_run(2) == expected_next_run, "Order #2 not rescheduled");
+    ASSERT_TRUE(read_standing_order_next_run(4) == future_time, "Future order #4 should be unchanged");
+    ASSERT_TRUE(read_standing_order_next_run(3) == -1, "Order #3 to a closed account should be dropped");
+    ASSERT_TRUE(read_standing_order_next_run(5) == expected_weekly_run, 
+                "Order #5 to an unreadable but listed account should be kept");
+    ASSERT_TRUE(file_contains("../database/transaction.log", "Standing Order #5: Transfer to Account 1000011 failed (account unavailable)"), 
+                "Order #5 should be logged as a failed run");
+    printf("  - Orders rescheduled, closed account order dropped, unreadable account order kept ✓\n");
+    
+    // Each account is written once: one journal entry and one balance line per account
+    char batch_log[200];
+    sprintf(batch_log, "../database/transaction_batch_%ld.log", (long)now);
+    ASSERT_EQUAL(2, count_lines_with_prefix(batch_log, "Account: "), "Journal should list each changed account once");
+    ASSERT_TRUE(file_contains(batch_log, "Status: COMPLETED"), "Batch journal not marked COMPLETED");
+    
+    sprintf(account_file, "../database/%d.txt", sender_account);
+    ASSERT_EQUAL(1, count_lines_with_prefix(account_file, "Current Balance: "), "Sender file should have one balance line");
+    printf("  - Batch journal completed, accounts written once ✓\n");
+    
+    // Deleting the receiver cancels every order that references it
+    ASSERT_TRUE(chdir("..") == 0, "Could not change to application directory");
+    int removed = remove_standing_orders_for_account(receiver_account);
+    ASSERT_TRUE(chdir("test_cases") == 0, "Could not return to test_cases directory");
+    
+    ASSERT_EQUAL(3, removed, "All orders linked to the deleted account should be removed");
+    ASSERT_TRUE(read_standing_order_next_run(1) == -1 && read_standing_order_next_run(2) == -1 &&
+                read_standing_order_next_run(4) == -1, "Orders linked to the deleted account remain");
+    printf("  - Orders cancelled when account deleted ✓\n");
+    
+    TEST_PASS("Standing order batch runs, reschedules and cleans up correctly");
+    return 1;
+}
+
 // ==================== MAIN TEST RUNNER ====================
 
 void print_test_summary() {
@@ -643,6 +810,7 @@ int main(int argc, char *argv[]) {
     test_transfer_rollback();
     test_buffer_overflow();
     test_complete_lifecycle();
+    test_standing_order_batch();
     
     // Print summary
     print_test_summary();